@@ -28,6 +28,16 @@ typedef struct __HeapSsoStr {
     uint64_t length;
 } __HeapSsoStr;
 
+#define __SSO_GLOB_MAX_TOKENS 63
+
+/// Compiled glob pattern. Each non-`*` token of the pattern is one NFA state, which is
+/// simulated with a single 64 bit word (shift-and), so matching is linear and never allocates.
+typedef struct SsoGlob {
+    uint64_t char_masks[256];
+    uint64_t star_mask;
+    uint64_t accept_mask;
+} SsoGlob;
+
 
 SsoString SsoString_from_cstr(const char* c_str);
 char* SsoString_as_cstr(const SsoString* str);
@@ -42,5 +52,28 @@ int64_t SsoString_find(const SsoString* str, const char* c_str);
 int64_t SsoString_rfind(const SsoString* str, const char* c_str);
 void SsoString_trim(SsoString* str);
 int32_t SsoString_split(const SsoString* str, const char* delimiter, SsoString** output_buffer, uint64_t* buffer_len);
+void SsoString_shrink_to_fit(SsoString* str);
+void SsoString_set_auto_demote(bool enabled);
+uint64_t SsoString_memory_usage(const SsoString* str);
+
+SsoString SsoString_from_i64(int64_t value);
+SsoString SsoString_from_u64(uint64_t value);
+SsoString SsoString_from_f64(double value);
+int32_t SsoString_parse_i64(const SsoString* str, int64_t* out);
+int32_t SsoString_parse_f64(const SsoString* str, double* out);
+SsoString SsoString_hex_encode(const uint8_t* data, uint64_t len);
+int32_t SsoString_hex_decode(const SsoString* str, uint8_t** output_buffer, uint64_t* buffer_len);
+SsoString SsoString_base64_encode(const uint8_t* data, uint64_t len, bool url_safe);
+int32_t SsoString_base64_decode(const SsoString* str, bool url_safe, uint8_t** output_buffer, uint64_t* buffer_len);
+int64_t SsoString_edit_distance(const SsoString* s1, const SsoString* s2);
+int64_t SsoString_edit_distance_bounded(const SsoString* s1, const SsoString* s2, uint64_t max_distance);
+int64_t SsoString_fuzzy_find(const SsoString* str, const char* c_str, uint64_t max_distance, uint64_t* match_len, uint64_t* distance);
+void SsoString_edit_distance_batch(const SsoString* query, const SsoString* candidates, uint64_t n, uint64_t max_distance, int64_t* distances, uint32_t num_threads);
+uint64_t SsoString_read_files_batch(const char** paths, uint64_t n, SsoString* out);
+
+int32_t SsoGlob_compile(SsoGlob* glob, const char* pattern);
+bool SsoGlob_match_cstr(const SsoGlob* glob, const char* c_str, uint64_t len);
+bool SsoGlob_match(const SsoGlob* glob, const SsoString* str);
+uint64_t SsoGlob_match_batch(const SsoGlob* glob, const SsoString* strs, uint64_t n, bool* results);
 
 #endif // SSO_STRING_H
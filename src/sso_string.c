@@ -1,10 +1,35 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
 #include <ctype.h>
+#include <math.h>
+#include <locale.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include "../include/sso_string.h"
+#include "sso_string_pow10.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define __SSO_STRING_X86_SIMD
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define __SSO_STRING_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#endif
 
 /// @brief Creates an SsoString object from a regular C String
 /// @param c_str
@@ -208,6 +233,27 @@ int64_t SsoString_rfind(const SsoString* str, const char* c_str) {
     return -1;
 }
 
+static bool __sso_string_auto_demote = false;
+
+/// Moves a heap string that fits in 22 bytes back into the inline buffer
+static void __SsoString_demote(SsoString* str) {
+    if (!SsoString_is_heap_allocated(str)) {
+        return;
+    }
+    __HeapSsoStr* heap_str = (__HeapSsoStr*) str;
+    uint64_t len = heap_str->length & (~__SSO_STRING_64th_BIT_MAX);
+    if (len > 22) {
+        return;
+    }
+
+    uint8_t* heap_ptr = heap_str->ptr;
+    __StackSsoStr* stack_str = (__StackSsoStr*) str;
+    memcpy(stack_str->chars, heap_ptr, len);
+    stack_str->chars[len] = '\0';
+    stack_str->type_flag = 0;
+    free(heap_ptr);
+}
+
 /// @brief Removes all white space characters from the start and end of the string. 
 /// @param str 
 void SsoString_trim(SsoString* str) {
@@ -234,6 +280,9 @@ void SsoString_trim(SsoString* str) {
             __StackSsoStr* stack_str = (__StackSsoStr*)str;
             stack_str->chars[0] = '\0';
         }
+        if (__sso_string_auto_demote) {
+            __SsoString_demote(str);
+        }
         return;
     }
     
@@ -276,6 +325,56 @@ void SsoString_trim(SsoString* str) {
         // Add null terminator
         stack_str->chars[new_len] = '\0';
     }
+
+    if (__sso_string_auto_demote) {
+        __SsoString_demote(str);
+    }
+}
+
+/// @brief Releases unused capacity. Heap strings of 22 characters or fewer are moved back into the inline buffer,
+/// longer ones are reallocated to exactly fit their length.
+/// @param str
+void SsoString_shrink_to_fit(SsoString* str) {
+    if (!SsoString_is_heap_allocated(str)) {
+        return;
+    }
+
+    __HeapSsoStr* heap_str = (__HeapSsoStr*) str;
+    uint64_t len = heap_str->length & (~__SSO_STRING_64th_BIT_MAX);
+    if (len <= 22) {
+        __SsoString_demote(str);
+        return;
+    }
+    if (heap_str->capacity == len + 1) {
+        return;
+    }
+
+    uint8_t* new_ptr = realloc(heap_str->ptr, len + 1);
+    if (!new_ptr) {
+        perror("Failed to reallocate memory in SsoString_shrink_to_fit");
+        exit(1);
+    }
+    heap_str->ptr = new_ptr;
+    heap_str->capacity = len + 1;
+}
+
+/// @brief Opt-in policy: when enabled, operations that shorten a string (currently `SsoString_trim`) move heap
+/// strings that now fit in 22 characters back into the inline buffer. Disabled by default. This is a process-wide
+/// setting and is meant to be set once at startup, before strings are shared between threads.
+/// @param enabled
+void SsoString_set_auto_demote(bool enabled) {
+    __sso_string_auto_demote = enabled;
+}
+
+/// @brief
+/// @param str
+/// @return Returns the number of bytes held by the string: the struct itself plus its heap capacity (if any)
+uint64_t SsoString_memory_usage(const SsoString* str) {
+    if (SsoString_is_heap_allocated(str)) {
+        __HeapSsoStr* heap_str = (__HeapSsoStr*) str;
+        return sizeof(SsoString) + heap_str->capacity;
+    }
+    return sizeof(SsoString);
 }
 
 /// @brief 
@@ -389,4 +488,1923 @@ int32_t SsoString_split(const SsoString* str, const char* delimiter, SsoString**
     }
     
     return 0;
-}
\ No newline at end of file
+}
+
+static const char __SSO_DIGIT_PAIRS[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const double __SSO_POW10[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/// Initializes `str` to exactly `len` characters (inline when it fits) and returns a pointer to its
+/// uninitialized character buffer. The null terminator is already written.
+static char* __SsoString_init_with_len(SsoString* str, uint64_t len) {
+    if (len <= 22) {
+        __StackSsoStr* str_ptr = (__StackSsoStr*) str;
+        str_ptr->chars[len] = '\0';
+        str_ptr->type_flag = 0;
+        return (char*) &str_ptr->chars[0];
+    } else if (len >= __SSO_STRING_MAX_CAP) {
+        perror("length of this string exceeds the maximum supported size (and almost certainly your available memory)");
+        exit(1);
+    }
+
+    __HeapSsoStr* str_ptr = (__HeapSsoStr*) str;
+    str_ptr->capacity = len + 1;
+    str_ptr->length = len | __SSO_STRING_64th_BIT_MAX;
+    str_ptr->ptr = malloc(str_ptr->capacity);
+    if (!str_ptr->ptr) {
+        perror("Failed to allocate memory in __SsoString_init_with_len");
+        exit(1);
+    }
+    str_ptr->ptr[len] = '\0';
+    return (char*) str_ptr->ptr;
+}
+
+/// Builds a string from `len` bytes without calling strlen (inline when it fits)
+static SsoString __SsoString_from_buf(const char* buf, uint64_t len) {
+    SsoString str;
+    memcpy(__SsoString_init_with_len(&str, len), buf, len);
+    return str;
+}
+
+/// Writes the digits of `value` ending just before `end`, two at a time. Returns a pointer to the first digit.
+static char* __SsoString_write_u64(char* end, uint64_t value) {
+    while (value >= 100) {
+        uint64_t pair = (value % 100) * 2;
+        value /= 100;
+        *--end = __SSO_DIGIT_PAIRS[pair + 1];
+        *--end = __SSO_DIGIT_PAIRS[pair];
+    }
+    if (value >= 10) {
+        *--end = __SSO_DIGIT_PAIRS[value * 2 + 1];
+        *--end = __SSO_DIGIT_PAIRS[value * 2];
+    } else {
+        *--end = (char)('0' + value);
+    }
+    return end;
+}
+
+/// @brief Formats an integer directly into the inline buffer (every 64 bit integer fits, so this never allocates)
+/// @param value
+/// @return
+SsoString SsoString_from_i64(int64_t value) {
+    char buf[24];
+    char* end = buf + sizeof(buf);
+    uint64_t magnitude = value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+    char* start = __SsoString_write_u64(end, magnitude);
+    if (value < 0) {
+        *--start = '-';
+    }
+    return __SsoString_from_buf(start, end - start);
+}
+
+/// @brief Formats an unsigned integer directly into the inline buffer (never allocates)
+/// @param value
+/// @return
+SsoString SsoString_from_u64(uint64_t value) {
+    char buf[24];
+    char* end = buf + sizeof(buf);
+    char* start = __SsoString_write_u64(end, value);
+    return __SsoString_from_buf(start, end - start);
+}
+
+/// Full 64 x 64 -> 128 bit multiply
+static inline void __SsoString_mul_128(uint64_t a, uint64_t b, uint64_t* hi, uint64_t* lo) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 product = (unsigned __int128) a * b;
+    *hi = (uint64_t) (product >> 64);
+    *lo = (uint64_t) product;
+#else
+    uint64_t a_lo = (uint32_t) a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t) b, b_hi = b >> 32;
+    uint64_t p0 = a_lo * b_lo;
+    uint64_t p1 = a_lo * b_hi;
+    uint64_t p2 = a_hi * b_lo;
+    uint64_t p3 = a_hi * b_hi;
+    uint64_t middle = (p0 >> 32) + (uint32_t) p1 + (uint32_t) p2;
+    *lo = (middle << 32) | (uint32_t) p0;
+    *hi = p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32);
+#endif
+}
+
+/// floor(log10(2^e)), floor(log10(3/4 * 2^e)) and floor(log2(10^e)) for the exponent ranges of a double
+static inline int32_t __SsoString_floor_log10_pow2(int32_t e) {
+    return (e * 315653) >> 20;
+}
+
+static inline int32_t __SsoString_floor_log10_three_quarters_pow2(int32_t e) {
+    return (e * 1262611 - 524031) >> 22;
+}
+
+static inline int32_t __SsoString_floor_log2_pow10(int32_t e) {
+    return (e * 1741647) >> 19;
+}
+
+/// Returns the top 64 bits of g * cp (g being a 128 bit table entry), rounded to odd
+static inline uint64_t __SsoString_round_to_odd(const uint64_t g[2], uint64_t cp) {
+    uint64_t x_hi, x_lo, y_hi, y_lo;
+    __SsoString_mul_128(g[1], cp, &x_hi, &x_lo);
+    __SsoString_mul_128(g[0], cp, &y_hi, &y_lo);
+    uint64_t z = y_lo + x_hi;
+    y_hi += z < y_lo;
+    return y_hi | (z > 1);
+}
+
+/// Schubfach (Giulietti): computes the shortest decimal digits * 10^exponent that round trips to the
+/// finite, non-zero double with the given bits. Ties pick the decimal closest to the exact value.
+static void __SsoString_shortest_f64(uint64_t bits, uint64_t* digits, int32_t* exponent) {
+    uint64_t ieee_mantissa = bits & (((uint64_t)1 << 52) - 1);
+    int32_t ieee_exponent = (int32_t)((bits >> 52) & 0x7FF);
+
+    uint64_t c = ieee_mantissa;
+    int32_t q = 1 - 1075;
+    if (ieee_exponent != 0) {
+        c |= (uint64_t)1 << 52;
+        q = ieee_exponent - 1075;
+    }
+
+    bool is_even = (c % 2) == 0;
+    bool lower_boundary_is_closer = ieee_mantissa == 0 && ieee_exponent > 1;
+
+    uint64_t cbl = 4 * c - 2 + lower_boundary_is_closer;
+    uint64_t cb = 4 * c;
+    uint64_t cbr = 4 * c + 2;
+
+    int32_t k = lower_boundary_is_closer ? __SsoString_floor_log10_three_quarters_pow2(q) : __SsoString_floor_log10_pow2(q);
+    int32_t h = q + __SsoString_floor_log2_pow10(-k) + 1;
+    const uint64_t* g = __SSO_POW10_128[-k - __SSO_POW10_128_MIN];
+
+    uint64_t vbl = __SsoString_round_to_odd(g, cbl << h);
+    uint64_t vb = __SsoString_round_to_odd(g, cb << h);
+    uint64_t vbr = __SsoString_round_to_odd(g, cbr << h);
+
+    uint64_t lower = vbl + !is_even;
+    uint64_t upper = vbr - !is_even;
+
+    uint64_t s = vb / 4;
+    uint64_t result;
+    int32_t result_exponent = k;
+
+    // Try one digit fewer first, then the two candidates around the exact value
+    bool done = false;
+    if (s >= 10) {
+        uint64_t sp = s / 10;
+        bool up_inside = lower <= 40 * sp;
+        bool wp_inside = 40 * sp + 40 <= upper;
+        if (up_inside != wp_inside) {
+            result = sp + wp_inside;
+            result_exponent = k + 1;
+            done = true;
+        }
+    }
+    if (!done) {
+        bool u_inside = lower <= 4 * s;
+        bool w_inside = 4 * s + 4 <= upper;
+        if (u_inside != w_inside) {
+            result = s + w_inside;
+        } else {
+            uint64_t mid = 4 * s + 2;
+            bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+            result = s + round_up;
+        }
+    }
+
+    while (result % 10 == 0) {
+        result /= 10;
+        result_exponent++;
+    }
+    *digits = result;
+    *exponent = result_exponent;
+}
+
+/// @brief Formats a double using the shortest representation that parses back to the exact same value
+/// (Schubfach). Uses plain notation for decimal exponents from -6 to 21 and `1.5e+300` style otherwise.
+/// The output is locale independent.
+/// @param value
+/// @return
+SsoString SsoString_from_f64(double value) {
+    if (isnan(value)) {
+        return __SsoString_from_buf("nan", 3);
+    } else if (isinf(value)) {
+        return value < 0 ? __SsoString_from_buf("-inf", 4) : __SsoString_from_buf("inf", 3);
+    } else if (value == 0) {
+        return signbit(value) ? __SsoString_from_buf("-0", 2) : __SsoString_from_buf("0", 1);
+    }
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint64_t digits;
+    int32_t exponent;
+    __SsoString_shortest_f64(bits, &digits, &exponent);
+
+    char digit_buf[24];
+    char* digit_end = digit_buf + sizeof(digit_buf);
+    char* digit_start = __SsoString_write_u64(digit_end, digits);
+    int32_t n = (int32_t)(digit_end - digit_start);
+    // The value is 0.d1d2d3... * 10^point
+    int32_t point = n + exponent;
+
+    char buf[40];
+    char* out = buf;
+    if (signbit(value)) {
+        *out++ = '-';
+    }
+
+    if (point > 0 && point <= 21) {
+        if (exponent >= 0) {
+            memcpy(out, digit_start, n);
+            memset(out + n, '0', exponent);
+            out += n + exponent;
+        } else {
+            memcpy(out, digit_start, point);
+            out[point] = '.';
+            memcpy(out + point + 1, digit_start + point, n - point);
+            out += n + 1;
+        }
+    } else if (point > -6 && point <= 0) {
+        *out++ = '0';
+        *out++ = '.';
+        memset(out, '0', -point);
+        out += -point;
+        memcpy(out, digit_start, n);
+        out += n;
+    } else {
+        *out++ = digit_start[0];
+        if (n > 1) {
+            *out++ = '.';
+            memcpy(out, digit_start + 1, n - 1);
+            out += n - 1;
+        }
+        int32_t sci_exponent = point - 1;
+        *out++ = 'e';
+        *out++ = sci_exponent < 0 ? '-' : '+';
+        char exp_buf[8];
+        char* exp_end = exp_buf + sizeof(exp_buf);
+        char* exp_start = __SsoString_write_u64(exp_end, (uint64_t)(sci_exponent < 0 ? -sci_exponent : sci_exponent));
+        memcpy(out, exp_start, exp_end - exp_start);
+        out += exp_end - exp_start;
+    }
+
+    return __SsoString_from_buf(buf, out - buf);
+}
+
+/// Returns true if all 8 bytes of `chunk` are ASCII digits
+static bool __SsoString_is_8_digits(uint64_t chunk) {
+    return (((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+             (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+}
+
+/// Converts 8 ASCII digits (little endian load) into their value with three multiplies
+static uint64_t __SsoString_parse_8_digits(uint64_t chunk) {
+    chunk -= 0x3030303030303030ULL;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+             (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return chunk;
+}
+
+/// @brief Parses the whole string as a base 10 integer with an optional sign. Locale independent.
+/// @param str
+/// @param out Receives the value on success
+/// @return 0 on success, 1 if the string is not a valid integer, 2 if the value does not fit in an int64_t
+int32_t SsoString_parse_i64(const SsoString* str, int64_t* out) {
+    const char* c_str = SsoString_as_cstr(str);
+    uint64_t len = SsoString_len(str);
+    uint64_t i = 0;
+
+    bool negative = false;
+    if (i < len && (c_str[i] == '-' || c_str[i] == '+')) {
+        negative = c_str[i] == '-';
+        i++;
+    }
+    if (i == len) {
+        return 1;
+    }
+
+    uint64_t value = 0;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // Consume 8 digits at a time while they cannot overflow
+    while (len - i >= 8 && value < 100000000000ULL) {
+        uint64_t chunk;
+        memcpy(&chunk, c_str + i, 8);
+        if (!__SsoString_is_8_digits(chunk)) {
+            break;
+        }
+        value = value * 100000000ULL + __SsoString_parse_8_digits(chunk);
+        i += 8;
+    }
+#endif
+
+    for (; i < len; i++) {
+        uint8_t digit = (uint8_t)c_str[i] - '0';
+        if (digit > 9) {
+            return 1;
+        }
+        if (value > (UINT64_MAX - digit) / 10) {
+            return 2;
+        }
+        value = value * 10 + digit;
+    }
+
+    if (negative) {
+        if (value > __SSO_STRING_64th_BIT_MAX) {
+            return 2;
+        }
+        *out = (int64_t)((uint64_t)0 - value);
+    } else {
+        if (value >= __SSO_STRING_64th_BIT_MAX) {
+            return 2;
+        }
+        *out = (int64_t)value;
+    }
+    return 0;
+}
+
+/// Eisel-Lemire: converts mantissa * 10^exponent (mantissa != 0) to the nearest double using the truncated
+/// 128 bit power of ten. Returns false when the product is too close to a rounding boundary to decide.
+static bool __SsoString_eisel_lemire(uint64_t mantissa, int64_t exponent, double* out) {
+    if (exponent < __SSO_POW10_128_MIN) {
+        *out = 0.0;
+        return true;
+    } else if (exponent > 308) {
+        *out = INFINITY;
+        return true;
+    }
+
+    // The table stores the truncated value plus one. Eisel-Lemire wants positive powers truncated (exact up to
+    // 10^55) and negative powers rounded up, which is the entry itself since those are never exact.
+    const uint64_t* entry = __SSO_POW10_128[exponent - __SSO_POW10_128_MIN];
+    uint64_t pow_hi = entry[0];
+    uint64_t pow_lo = entry[1];
+    if (exponent >= 0) {
+        pow_hi -= pow_lo == 0;
+        pow_lo--;
+    }
+
+    int32_t leading_zeros = __builtin_clzll(mantissa);
+    mantissa <<= leading_zeros;
+
+    uint64_t product_hi, product_lo;
+    __SsoString_mul_128(mantissa, pow_hi, &product_hi, &product_lo);
+    // Only the top 55 bits matter; refine with the low word when the rest could still carry into them
+    if ((product_hi & 0x1FF) == 0x1FF) {
+        uint64_t second_hi, second_lo;
+        __SsoString_mul_128(mantissa, pow_lo, &second_hi, &second_lo);
+        product_lo += second_hi;
+        if (second_hi > product_lo) {
+            product_hi++;
+        }
+    }
+    if (product_lo == UINT64_MAX && (exponent < -27 || exponent > 55)) {
+        return false;
+    }
+
+    uint64_t upper_bit = product_hi >> 63;
+    uint64_t result = product_hi >> (upper_bit + 9);
+    int32_t power2 = __SsoString_floor_log2_pow10((int32_t) exponent) + 63 + (int32_t) upper_bit - leading_zeros + 1023;
+
+    if (power2 <= 0) {
+        // Subnormal (or underflow to zero)
+        if (-power2 + 1 >= 64) {
+            *out = 0.0;
+            return true;
+        }
+        result >>= -power2 + 1;
+        result += result & 1;
+        result >>= 1;
+        power2 = result < ((uint64_t)1 << 52) ? 0 : 1;
+        uint64_t bits = (result & (((uint64_t)1 << 52) - 1)) | ((uint64_t) power2 << 52);
+        memcpy(out, &bits, sizeof(*out));
+        return true;
+    }
+
+    // Exactly halfway between two doubles: round to even instead of up
+    if (product_lo <= 1 && exponent >= -4 && exponent <= 23 && (result & 3) == 1 &&
+        (result << (upper_bit + 9)) == product_hi) {
+        result &= ~(uint64_t)1;
+    }
+
+    result += result & 1;
+    result >>= 1;
+    if (result >= ((uint64_t)2 << 52)) {
+        result = (uint64_t)1 << 52;
+        power2++;
+    }
+    if (power2 >= 0x7FF) {
+        *out = INFINITY;
+        return true;
+    }
+
+    uint64_t bits = (result & (((uint64_t)1 << 52) - 1)) | ((uint64_t) power2 << 52);
+    memcpy(out, &bits, sizeof(*out));
+    return true;
+}
+
+/// @brief Parses the whole string as a floating point number (`[sign] digits [. digits] [e [sign] digits]`,
+/// `inf`, `infinity` or `nan`). Locale independent. Numbers with at most 15 significant digits and a small
+/// exponent are converted exactly with a single multiply or divide, anything else with up to 19 significant
+/// digits goes through Eisel-Lemire. Only the rare inputs neither can decide fall back to `strtod`.
+/// @param str
+/// @param out Receives the value on success
+/// @return 0 on success, 1 if the string is not a valid number, 2 if the value overflows a double
+int32_t SsoString_parse_f64(const SsoString* str, double* out) {
+    const char* c_str = SsoString_as_cstr(str);
+    uint64_t len = SsoString_len(str);
+    uint64_t i = 0;
+
+    bool negative = false;
+    if (i < len && (c_str[i] == '-' || c_str[i] == '+')) {
+        negative = c_str[i] == '-';
+        i++;
+    }
+
+    // Special values
+    const char* rest = c_str + i;
+    uint64_t rest_len = len - i;
+    if (rest_len > 0 && isalpha((unsigned char)rest[0])) {
+        char lower[9] = {0};
+        if (rest_len >= sizeof(lower)) {
+            return 1;
+        }
+        for (uint64_t j = 0; j < rest_len; j++) {
+            lower[j] = (char)tolower((unsigned char)rest[j]);
+        }
+        if (strcmp(lower, "inf") == 0 || strcmp(lower, "infinity") == 0) {
+            *out = negative ? -INFINITY : INFINITY;
+            return 0;
+        } else if (strcmp(lower, "nan") == 0) {
+            *out = negative ? -NAN : NAN;
+            return 0;
+        }
+        return 1;
+    }
+
+    uint64_t mantissa = 0;
+    int64_t exponent = 0;
+    uint64_t significant_digits = 0;
+    uint64_t digit_count = 0;
+    // Set when a non-zero digit past the 19th significant one had to be dropped
+    bool truncated = false;
+
+    for (; i < len && isdigit((unsigned char)c_str[i]); i++, digit_count++) {
+        if (significant_digits < 19) {
+            mantissa = mantissa * 10 + (c_str[i] - '0');
+            significant_digits += (mantissa != 0);
+        } else {
+            truncated |= c_str[i] != '0';
+            exponent++;
+        }
+    }
+    if (i < len && c_str[i] == '.') {
+        i++;
+        for (; i < len && isdigit((unsigned char)c_str[i]); i++, digit_count++) {
+            if (significant_digits < 19) {
+                mantissa = mantissa * 10 + (c_str[i] - '0');
+                significant_digits += (mantissa != 0);
+                exponent--;
+            } else {
+                truncated |= c_str[i] != '0';
+            }
+        }
+    }
+    if (digit_count == 0) {
+        return 1;
+    }
+
+    if (i < len && (c_str[i] == 'e' || c_str[i] == 'E')) {
+        i++;
+        bool exp_negative = false;
+        if (i < len && (c_str[i] == '-' || c_str[i] == '+')) {
+            exp_negative = c_str[i] == '-';
+            i++;
+        }
+        if (i == len) {
+            return 1;
+        }
+        int64_t exp_value = 0;
+        for (; i < len && isdigit((unsigned char)c_str[i]); i++) {
+            if (exp_value < 100000) {
+                exp_value = exp_value * 10 + (c_str[i] - '0');
+            }
+        }
+        exponent += exp_negative ? -exp_value : exp_value;
+    }
+    if (i != len) {
+        return 1;
+    }
+
+    // Clinger's fast path: both the mantissa and the power of ten are exact doubles,
+    // so one correctly rounded operation gives the correctly rounded result
+    if (significant_digits <= 15 && mantissa <= 9007199254740992ULL && exponent >= -22 && exponent <= 22) {
+        double value = (double)mantissa;
+        value = exponent < 0 ? value / __SSO_POW10[-exponent] : value * __SSO_POW10[exponent];
+        *out = negative ? -value : value;
+        return 0;
+    }
+
+    if (!truncated) {
+        if (mantissa == 0) {
+            *out = negative ? -0.0 : 0.0;
+            return 0;
+        }
+        double value;
+        if (__SsoString_eisel_lemire(mantissa, exponent, &value)) {
+            if (isinf(value)) {
+                return 2;
+            }
+            *out = negative ? -value : value;
+            return 0;
+        }
+    }
+
+    // Slow path: hand the validated text to strtod, translating the decimal point for the current locale
+    const char* point = localeconv()->decimal_point;
+    uint64_t point_len = strlen(point);
+    char stack_buf[128];
+    char* buf = stack_buf;
+    if (len * point_len + 1 > sizeof(stack_buf)) {
+        buf = malloc(len * point_len + 1);
+        if (!buf) {
+            perror("Failed to allocate memory in SsoString_parse_f64");
+            exit(1);
+        }
+    }
+    uint64_t buf_len = 0;
+    for (uint64_t j = 0; j < len; j++) {
+        if (c_str[j] == '.') {
+            memcpy(buf + buf_len, point, point_len);
+            buf_len += point_len;
+        } else {
+            buf[buf_len++] = c_str[j];
+        }
+    }
+    buf[buf_len] = '\0';
+
+    double value = strtod(buf, NULL);
+    if (buf != stack_buf) {
+        free(buf);
+    }
+
+    if (isinf(value)) {
+        return 2;
+    }
+    *out = value;
+    return 0;
+}
+
+/// Allocates the output buffer or checks that the caller's buffer is large enough, with the same
+/// conventions as `SsoString_split`. Returns 1 (and the required length) if the buffer is too small.
+static int32_t __SsoString_prepare_output(uint8_t** output_buffer, uint64_t* buffer_len, uint64_t required) {
+    if (*buffer_len == 0) {
+        *output_buffer = malloc(required > 0 ? required : 1);
+        if (*output_buffer == NULL) {
+            perror("Failed to allocate memory for the decoded output");
+            exit(1);
+        }
+    } else if (*buffer_len < required) {
+        *buffer_len = required;
+        return 1;
+    }
+    *buffer_len = required;
+    return 0;
+}
+
+static const char __SSO_HEX_CHARS[17] = "0123456789abcdef";
+
+#ifdef __SSO_STRING_X86_SIMD
+/// Encodes 16 bytes into 32 hex characters per iteration. Returns the number of input bytes consumed.
+__attribute__((target("ssse3")))
+static uint64_t __SsoString_hex_encode_ssse3(const uint8_t* data, uint64_t len, char* out) {
+    const __m128i lut = _mm_loadu_si128((const __m128i*) __SSO_HEX_CHARS);
+    const __m128i low_mask = _mm_set1_epi8(0x0f);
+    uint64_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i input = _mm_loadu_si128((const __m128i*) (data + i));
+        __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(input, 4), low_mask));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(input, low_mask));
+        _mm_storeu_si128((__m128i*) (out + i * 2), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i*) (out + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return i;
+}
+
+/// Encodes 32 bytes into 64 hex characters per iteration. Returns the number of input bytes consumed.
+__attribute__((target("avx2")))
+static uint64_t __SsoString_hex_encode_avx2(const uint8_t* data, uint64_t len, char* out) {
+    const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) __SSO_HEX_CHARS));
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    uint64_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i input = _mm256_loadu_si256((const __m256i*) (data + i));
+        __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_mask));
+        __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(input, low_mask));
+        // The unpacks work per 128 bit lane, so the lanes hold bytes 0-7, 16-23 and 8-15, 24-31
+        __m256i first = _mm256_unpacklo_epi8(hi, lo);
+        __m256i second = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i*) (out + i * 2), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256((__m256i*) (out + i * 2 + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return i;
+}
+#endif
+
+/// @brief Encodes bytes as lowercase hex. The result is sized exactly, so inputs up to 11 bytes stay inline.
+/// @param data
+/// @param len The number of bytes in `data`
+/// @return
+SsoString SsoString_hex_encode(const uint8_t* data, uint64_t len) {
+    SsoString str;
+    char* out = __SsoString_init_with_len(&str, len * 2);
+
+    uint64_t i = 0;
+#ifdef __SSO_STRING_X86_SIMD
+    if (len >= 16) {
+        if (__builtin_cpu_supports("avx2")) {
+            i = __SsoString_hex_encode_avx2(data, len, out);
+        }
+        if (__builtin_cpu_supports("ssse3")) {
+            i += __SsoString_hex_encode_ssse3(data + i, len - i, out + i * 2);
+        }
+    }
+#endif
+    for (; i < len; i++) {
+        out[i * 2] = __SSO_HEX_CHARS[data[i] >> 4];
+        out[i * 2 + 1] = __SSO_HEX_CHARS[data[i] & 0x0f];
+    }
+    return str;
+}
+
+/// Value of each hex digit (either case), -1 for every other byte
+static const int8_t __SSO_HEX_VALUES[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+#ifdef __SSO_STRING_X86_SIMD
+// A byte is a hex digit exactly when the class bits looked up by its low and high nibble share nothing.
+// Digits have high nibble 3, letters 4 or 6, and the low nibble then selects the value: the digit itself,
+// or 9 more than it for a letter.
+#define __SSO_HEX_NIBBLE_LO 0x06, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x06, 0x06, 0x06, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07
+#define __SSO_HEX_NIBBLE_HI 0x04, 0x04, 0x04, 0x01, 0x02, 0x04, 0x02, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04
+#define __SSO_HEX_NIBBLE_ADD 0, 0, 0, 0, 9, 0, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0
+
+/// Decodes 32 hex characters into 16 bytes per iteration. Stops before the first block holding an invalid
+/// character, and only validates if `out` is NULL. Returns the number of characters processed.
+__attribute__((target("ssse3")))
+static uint64_t __SsoString_hex_decode_ssse3(const uint8_t* in, uint64_t len, uint8_t* out) {
+    const __m128i lut_lo = _mm_setr_epi8(__SSO_HEX_NIBBLE_LO);
+    const __m128i lut_hi = _mm_setr_epi8(__SSO_HEX_NIBBLE_HI);
+    const __m128i lut_add = _mm_setr_epi8(__SSO_HEX_NIBBLE_ADD);
+    const __m128i low_mask = _mm_set1_epi8(0x0f);
+    uint64_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m128i a = _mm_loadu_si128((const __m128i*) (in + i));
+        __m128i b = _mm_loadu_si128((const __m128i*) (in + i + 16));
+        __m128i a_lo = _mm_and_si128(a, low_mask);
+        __m128i a_hi = _mm_and_si128(_mm_srli_epi16(a, 4), low_mask);
+        __m128i b_lo = _mm_and_si128(b, low_mask);
+        __m128i b_hi = _mm_and_si128(_mm_srli_epi16(b, 4), low_mask);
+
+        __m128i bad = _mm_or_si128(_mm_and_si128(_mm_shuffle_epi8(lut_lo, a_lo), _mm_shuffle_epi8(lut_hi, a_hi)),
+                                   _mm_and_si128(_mm_shuffle_epi8(lut_lo, b_lo), _mm_shuffle_epi8(lut_hi, b_hi)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(bad, _mm_setzero_si128())) != 0xffff) {
+            break;
+        }
+        if (out) {
+            // Each pair of nibble values becomes high * 16 + low in one 16 bit lane
+            __m128i a_values = _mm_add_epi8(a_lo, _mm_shuffle_epi8(lut_add, a_hi));
+            __m128i b_values = _mm_add_epi8(b_lo, _mm_shuffle_epi8(lut_add, b_hi));
+            __m128i a_bytes = _mm_maddubs_epi16(a_values, _mm_set1_epi16(0x0110));
+            __m128i b_bytes = _mm_maddubs_epi16(b_values, _mm_set1_epi16(0x0110));
+            _mm_storeu_si128((__m128i*) (out + i / 2), _mm_packus_epi16(a_bytes, b_bytes));
+        }
+    }
+    return i;
+}
+
+/// AVX2 version of `__SsoString_hex_decode_ssse3`, 64 characters per iteration.
+__attribute__((target("avx2")))
+static uint64_t __SsoString_hex_decode_avx2(const uint8_t* in, uint64_t len, uint8_t* out) {
+    const __m256i lut_lo = _mm256_setr_epi8(__SSO_HEX_NIBBLE_LO, __SSO_HEX_NIBBLE_LO);
+    const __m256i lut_hi = _mm256_setr_epi8(__SSO_HEX_NIBBLE_HI, __SSO_HEX_NIBBLE_HI);
+    const __m256i lut_add = _mm256_setr_epi8(__SSO_HEX_NIBBLE_ADD, __SSO_HEX_NIBBLE_ADD);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    uint64_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        __m256i a = _mm256_loadu_si256((const __m256i*) (in + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*) (in + i + 32));
+        __m256i a_lo = _mm256_and_si256(a, low_mask);
+        __m256i a_hi = _mm256_and_si256(_mm256_srli_epi16(a, 4), low_mask);
+        __m256i b_lo = _mm256_and_si256(b, low_mask);
+        __m256i b_hi = _mm256_and_si256(_mm256_srli_epi16(b, 4), low_mask);
+
+        __m256i bad = _mm256_or_si256(
+            _mm256_and_si256(_mm256_shuffle_epi8(lut_lo, a_lo), _mm256_shuffle_epi8(lut_hi, a_hi)),
+            _mm256_and_si256(_mm256_shuffle_epi8(lut_lo, b_lo), _mm256_shuffle_epi8(lut_hi, b_hi)));
+        if (!_mm256_testz_si256(bad, bad)) {
+            break;
+        }
+        if (out) {
+            __m256i a_values = _mm256_add_epi8(a_lo, _mm256_shuffle_epi8(lut_add, a_hi));
+            __m256i b_values = _mm256_add_epi8(b_lo, _mm256_shuffle_epi8(lut_add, b_hi));
+            __m256i a_bytes = _mm256_maddubs_epi16(a_values, _mm256_set1_epi16(0x0110));
+            __m256i b_bytes = _mm256_maddubs_epi16(b_values, _mm256_set1_epi16(0x0110));
+            // The pack interleaves the 64 bit halves of the two inputs by lane; put them back in order
+            __m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(a_bytes, b_bytes), 0xd8);
+            _mm256_storeu_si256((__m256i*) (out + i / 2), bytes);
+        }
+    }
+    return i;
+}
+#endif
+
+/// Runs the widest hex decode kernel the CPU supports over the start of `in`, see `__SsoString_hex_decode_ssse3`.
+static uint64_t __SsoString_hex_decode_simd(const uint8_t* in, uint64_t len, uint8_t* out) {
+    uint64_t i = 0;
+#ifdef __SSO_STRING_X86_SIMD
+    if (len >= 32) {
+        if (__builtin_cpu_supports("avx2")) {
+            i = __SsoString_hex_decode_avx2(in, len, out);
+        }
+        if (__builtin_cpu_supports("ssse3")) {
+            i += __SsoString_hex_decode_ssse3(in + i, len - i, out ? out + i / 2 : NULL);
+        }
+    }
+#else
+    (void) in;
+    (void) len;
+    (void) out;
+#endif
+    return i;
+}
+
+/// @brief Decodes a hex string (either case). Uses the same buffer conventions as `SsoString_split`.
+/// @param str
+/// @param output_buffer Pointer to the buffer the bytes are written to. If *buffer_len is 0, this function will allocate memory.
+/// @param buffer_len The length of the output buffer. Set to the number of decoded bytes (or the required length).
+/// @return 0 on success, 1 if the output buffer is not large enough, 2 if the input is not valid hex.
+/// On failure neither `*output_buffer` nor `*buffer_len` is touched, except for the required length on 1
+int32_t SsoString_hex_decode(const SsoString* str, uint8_t** output_buffer, uint64_t* buffer_len) {
+    const uint8_t* c_str = (const uint8_t*) SsoString_as_cstr(str);
+    uint64_t len = SsoString_len(str);
+
+    if (len % 2 != 0) {
+        return 2;
+    }
+
+    // Validate everything before touching the output, so a failed decode leaves the caller's buffer and
+    // length alone. Invalid bytes map to -1, so a single OR over the table values finds any of them.
+    // The SIMD kernels check whole blocks and leave the tail (or the block with the error) to the table.
+    int32_t invalid = 0;
+    for (uint64_t i = __SsoString_hex_decode_simd(c_str, len, NULL); i < len; i++) {
+        invalid |= __SSO_HEX_VALUES[c_str[i]];
+    }
+    if (invalid < 0) {
+        return 2;
+    }
+
+    if (__SsoString_prepare_output(output_buffer, buffer_len, len / 2) != 0) {
+        return 1;
+    }
+
+    uint8_t* out = *output_buffer;
+    for (uint64_t i = __SsoString_hex_decode_simd(c_str, len, out) / 2; i < len / 2; i++) {
+        out[i] = (uint8_t)((__SSO_HEX_VALUES[c_str[i * 2]] << 4) | __SSO_HEX_VALUES[c_str[i * 2 + 1]]);
+    }
+    return 0;
+}
+
+static const char __SSO_BASE64_CHARS[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char __SSO_BASE64_URL_CHARS[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+#ifdef __SSO_STRING_X86_SIMD
+/// Encodes 12 bytes into 16 characters per iteration (Muła's pshufb method). Needs 16 readable input
+/// bytes per iteration. Returns the number of input bytes consumed.
+__attribute__((target("ssse3")))
+static uint64_t __SsoString_base64_encode_ssse3(const uint8_t* data, uint64_t len, char* out, bool url_safe) {
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i shift_lut = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, (url_safe ? '-' : '+') - 62, (url_safe ? '_' : '/') - 63, 'A', 0, 0);
+
+    uint64_t i = 0;
+    uint64_t o = 0;
+    for (; i + 16 <= len; i += 12, o += 16) {
+        __m128i input = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + i)), shuffle);
+
+        // Split each 3 byte group into four 6 bit indices, one per output byte
+        __m128i t0 = _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00));
+        __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        __m128i t2 = _mm_and_si128(input, _mm_set1_epi32(0x003f03f0));
+        __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(t1, t3);
+
+        // Map each index range to the offset that turns it into its ASCII character
+        __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        reduced = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+        __m128i result = _mm_add_epi8(_mm_shuffle_epi8(shift_lut, reduced), indices);
+
+        _mm_storeu_si128((__m128i*) (out + o), result);
+    }
+    return i;
+}
+
+/// AVX2 version of `__SsoString_base64_encode_ssse3`: each lane encodes 12 bytes, so 24 bytes become 32
+/// characters per iteration. Needs 28 readable input bytes per iteration.
+__attribute__((target("avx2")))
+static uint64_t __SsoString_base64_encode_avx2(const uint8_t* data, uint64_t len, char* out, bool url_safe) {
+    const __m256i shuffle = _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                                            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m256i shift_lut = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, (url_safe ? '-' : '+') - 62, (url_safe ? '_' : '/') - 63, 'A', 0, 0));
+
+    uint64_t i = 0;
+    uint64_t o = 0;
+    for (; i + 28 <= len; i += 24, o += 32) {
+        __m256i input = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*) (data + i))),
+            _mm_loadu_si128((const __m128i*) (data + i + 12)), 1);
+        input = _mm256_shuffle_epi8(input, shuffle);
+
+        __m256i t0 = _mm256_and_si256(input, _mm256_set1_epi32(0x0fc0fc00));
+        __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        __m256i t2 = _mm256_and_si256(input, _mm256_set1_epi32(0x003f03f0));
+        __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        __m256i indices = _mm256_or_si256(t1, t3);
+
+        __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        reduced = _mm256_or_si256(reduced, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+        __m256i result = _mm256_add_epi8(_mm256_shuffle_epi8(shift_lut, reduced), indices);
+
+        _mm256_storeu_si256((__m256i*) (out + o), result);
+    }
+    return i;
+}
+#endif
+
+/// @brief Encodes bytes as base64. The standard alphabet is padded with `=`, the URL safe one is not.
+/// The result is sized exactly, so inputs up to 15 bytes stay inline.
+/// @param data
+/// @param len The number of bytes in `data`
+/// @param url_safe Use the `-_` alphabet without padding instead of `+/` with padding
+/// @return
+SsoString SsoString_base64_encode(const uint8_t* data, uint64_t len, bool url_safe) {
+    const char* alphabet = url_safe ? __SSO_BASE64_URL_CHARS : __SSO_BASE64_CHARS;
+    uint64_t out_len = url_safe ? (len * 4 + 2) / 3 : (len + 2) / 3 * 4;
+
+    SsoString str;
+    char* out = __SsoString_init_with_len(&str, out_len);
+
+    uint64_t i = 0;
+    uint64_t o = 0;
+#ifdef __SSO_STRING_X86_SIMD
+    if (len >= 16) {
+        if (__builtin_cpu_supports("avx2")) {
+            i = __SsoString_base64_encode_avx2(data, len, out, url_safe);
+        }
+        if (__builtin_cpu_supports("ssse3")) {
+            i += __SsoString_base64_encode_ssse3(data + i, len - i, out + i / 3 * 4, url_safe);
+        }
+        o = i / 3 * 4;
+    }
+#endif
+    for (; i + 3 <= len; i += 3, o += 4) {
+        uint32_t group = ((uint32_t)data[i] << 16) | ((uint32_t)data[i + 1] << 8) | data[i + 2];
+        out[o] = alphabet[(group >> 18) & 0x3f];
+        out[o + 1] = alphabet[(group >> 12) & 0x3f];
+        out[o + 2] = alphabet[(group >> 6) & 0x3f];
+        out[o + 3] = alphabet[group & 0x3f];
+    }
+
+    uint64_t remaining = len - i;
+    if (remaining > 0) {
+        uint32_t group = (uint32_t)data[i] << 16;
+        if (remaining == 2) {
+            group |= (uint32_t)data[i + 1] << 8;
+        }
+        out[o++] = alphabet[(group >> 18) & 0x3f];
+        out[o++] = alphabet[(group >> 12) & 0x3f];
+        if (remaining == 2) {
+            out[o++] = alphabet[(group >> 6) & 0x3f];
+        }
+        if (!url_safe) {
+            while (o < out_len) {
+                out[o++] = '=';
+            }
+        }
+    }
+    return str;
+}
+
+/// 6 bit value of each base64 character, -1 for bytes outside the alphabet (including padding)
+static const int8_t __SSO_BASE64_VALUES[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+static const int8_t __SSO_BASE64_URL_VALUES[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, 63,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+#ifdef __SSO_STRING_X86_SIMD
+// Nibble classes for both alphabets, as for hex: a byte is in the alphabet exactly when the bits looked up by
+// its low and high nibble share nothing. The value is the byte plus an offset picked by its high nibble; '/'
+// borrows the slot below its own and '_' needs 33 more than the other letters in its row.
+#define __SSO_BASE64_NIBBLE_LO 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+#define __SSO_BASE64_NIBBLE_HI 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+#define __SSO_BASE64_NIBBLE_ROLL 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+#define __SSO_BASE64_URL_NIBBLE_LO 0x25, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x23, 0x3B, 0x3B, 0x3A, 0x3B, 0x33
+#define __SSO_BASE64_URL_NIBBLE_HI 0x20, 0x20, 0x01, 0x02, 0x04, 0x08, 0x04, 0x10, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20
+#define __SSO_BASE64_URL_NIBBLE_ROLL 0, 0, 17, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+
+/// Decodes 16 base64 characters into 12 bytes per iteration. Stops before the first block holding a
+/// character outside the alphabet, and only validates if `out` is NULL. Returns the number of characters processed.
+__attribute__((target("ssse3")))
+static uint64_t __SsoString_base64_decode_ssse3(const uint8_t* in, uint64_t len, uint8_t* out, bool url_safe) {
+    const __m128i lut_lo = url_safe ? _mm_setr_epi8(__SSO_BASE64_URL_NIBBLE_LO) : _mm_setr_epi8(__SSO_BASE64_NIBBLE_LO);
+    const __m128i lut_hi = url_safe ? _mm_setr_epi8(__SSO_BASE64_URL_NIBBLE_HI) : _mm_setr_epi8(__SSO_BASE64_NIBBLE_HI);
+    const __m128i lut_roll = url_safe ? _mm_setr_epi8(__SSO_BASE64_URL_NIBBLE_ROLL) : _mm_setr_epi8(__SSO_BASE64_NIBBLE_ROLL);
+    const __m128i special = _mm_set1_epi8(url_safe ? '_' : '/');
+    const __m128i special_index = _mm_set1_epi8(url_safe ? 0 : -1);
+    const __m128i special_value = _mm_set1_epi8(url_safe ? 33 : 0);
+    const __m128i low_mask = _mm_set1_epi8(0x0f);
+    uint64_t i = 0;
+    uint64_t o = 0;
+    for (; i + 16 <= len; i += 16, o += 12) {
+        __m128i input = _mm_loadu_si128((const __m128i*) (in + i));
+        __m128i lo = _mm_and_si128(input, low_mask);
+        __m128i hi = _mm_and_si128(_mm_srli_epi32(input, 4), low_mask);
+        __m128i bad = _mm_and_si128(_mm_shuffle_epi8(lut_lo, lo), _mm_shuffle_epi8(lut_hi, hi));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(bad, _mm_setzero_si128())) != 0xffff) {
+            break;
+        }
+        if (out) {
+            __m128i is_special = _mm_cmpeq_epi8(input, special);
+            __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(hi, _mm_and_si128(is_special, special_index)));
+            __m128i values = _mm_add_epi8(_mm_add_epi8(input, roll), _mm_and_si128(is_special, special_value));
+
+            // Merge four 6 bit values into 24 bits per 32 bit lane, then drop the fourth byte of every lane
+            __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+            __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+            packed = _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+            _mm_storel_epi64((__m128i*) (out + o), packed);
+            int32_t last = _mm_cvtsi128_si32(_mm_srli_si128(packed, 8));
+            memcpy(out + o + 8, &last, sizeof(last));
+        }
+    }
+    return i;
+}
+
+/// AVX2 version of `__SsoString_base64_decode_ssse3`, 32 characters into 24 bytes per iteration.
+__attribute__((target("avx2")))
+static uint64_t __SsoString_base64_decode_avx2(const uint8_t* in, uint64_t len, uint8_t* out, bool url_safe) {
+    const __m256i lut_lo = url_safe ? _mm256_setr_epi8(__SSO_BASE64_URL_NIBBLE_LO, __SSO_BASE64_URL_NIBBLE_LO)
+                                    : _mm256_setr_epi8(__SSO_BASE64_NIBBLE_LO, __SSO_BASE64_NIBBLE_LO);
+    const __m256i lut_hi = url_safe ? _mm256_setr_epi8(__SSO_BASE64_URL_NIBBLE_HI, __SSO_BASE64_URL_NIBBLE_HI)
+                                    : _mm256_setr_epi8(__SSO_BASE64_NIBBLE_HI, __SSO_BASE64_NIBBLE_HI);
+    const __m256i lut_roll = url_safe ? _mm256_setr_epi8(__SSO_BASE64_URL_NIBBLE_ROLL, __SSO_BASE64_URL_NIBBLE_ROLL)
+                                      : _mm256_setr_epi8(__SSO_BASE64_NIBBLE_ROLL, __SSO_BASE64_NIBBLE_ROLL);
+    const __m256i special = _mm256_set1_epi8(url_safe ? '_' : '/');
+    const __m256i special_index = _mm256_set1_epi8(url_safe ? 0 : -1);
+    const __m256i special_value = _mm256_set1_epi8(url_safe ? 33 : 0);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    uint64_t i = 0;
+    uint64_t o = 0;
+    for (; i + 32 <= len; i += 32, o += 24) {
+        __m256i input = _mm256_loadu_si256((const __m256i*) (in + i));
+        __m256i lo = _mm256_and_si256(input, low_mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi32(input, 4), low_mask);
+        __m256i bad = _mm256_and_si256(_mm256_shuffle_epi8(lut_lo, lo), _mm256_shuffle_epi8(lut_hi, hi));
+        if (!_mm256_testz_si256(bad, bad)) {
+            break;
+        }
+        if (out) {
+            __m256i is_special = _mm256_cmpeq_epi8(input, special);
+            __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(hi, _mm256_and_si256(is_special, special_index)));
+            __m256i values = _mm256_add_epi8(_mm256_add_epi8(input, roll), _mm256_and_si256(is_special, special_value));
+
+            __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+            __m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+            packed = _mm256_shuffle_epi8(packed, _mm256_setr_epi8(
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+            // Each lane holds 12 bytes; move them next to each other
+            packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+            _mm_storeu_si128((__m128i*) (out + o), _mm256_castsi256_si128(packed));
+            _mm_storel_epi64((__m128i*) (out + o + 16), _mm256_extracti128_si256(packed, 1));
+        }
+    }
+    return i;
+}
+#endif
+
+/// Runs the widest base64 decode kernel the CPU supports over the start of `in`, see `__SsoString_base64_decode_ssse3`.
+static uint64_t __SsoString_base64_decode_simd(const uint8_t* in, uint64_t len, uint8_t* out, bool url_safe) {
+    uint64_t i = 0;
+#ifdef __SSO_STRING_X86_SIMD
+    if (len >= 16) {
+        if (__builtin_cpu_supports("avx2")) {
+            i = __SsoString_base64_decode_avx2(in, len, out, url_safe);
+        }
+        if (__builtin_cpu_supports("ssse3")) {
+            i += __SsoString_base64_decode_ssse3(in + i, len - i, out ? out + i / 4 * 3 : NULL, url_safe);
+        }
+    }
+#else
+    (void) in;
+    (void) len;
+    (void) out;
+    (void) url_safe;
+#endif
+    return i;
+}
+
+/// @brief Decodes base64. The standard alphabet must be padded to a multiple of 4 characters; padding is
+/// optional for the URL safe alphabet. Uses the same buffer conventions as `SsoString_split`.
+/// @param str
+/// @param url_safe Expect the `-_` alphabet instead of `+/`
+/// @param output_buffer Pointer to the buffer the bytes are written to. If *buffer_len is 0, this function will allocate memory.
+/// @param buffer_len The length of the output buffer. Set to the number of decoded bytes (or the required length).
+/// @return 0 on success, 1 if the output buffer is not large enough, 2 if the input is not valid base64.
+/// On failure neither `*output_buffer` nor `*buffer_len` is touched, except for the required length on 1
+int32_t SsoString_base64_decode(const SsoString* str, bool url_safe, uint8_t** output_buffer, uint64_t* buffer_len) {
+    const uint8_t* c_str = (const uint8_t*) SsoString_as_cstr(str);
+    uint64_t len = SsoString_len(str);
+
+    if (!url_safe && len % 4 != 0) {
+        return 2;
+    }
+
+    // Strip up to two padding characters
+    uint64_t padding = 0;
+    while (padding < 2 && len > 0 && c_str[len - 1] == '=') {
+        len--;
+        padding++;
+    }
+    if (padding > 0 && (len + padding) % 4 != 0) {
+        return 2;
+    }
+    // A single leftover character cannot encode a whole byte
+    if (len % 4 == 1) {
+        return 2;
+    }
+
+    // Validate everything before touching the output, so a failed decode leaves the caller's buffer and
+    // length alone. Bytes outside the alphabet map to -1, so a single OR over the table values finds any of them.
+    const int8_t* values = url_safe ? __SSO_BASE64_URL_VALUES : __SSO_BASE64_VALUES;
+    int32_t invalid = 0;
+    for (uint64_t i = __SsoString_base64_decode_simd(c_str, len, NULL, url_safe); i < len; i++) {
+        invalid |= values[c_str[i]];
+    }
+    if (invalid < 0) {
+        return 2;
+    }
+
+    // Reject non-canonical encodings where the unused low bits of the last character are set
+    uint64_t tail = len % 4;
+    if ((tail == 2 && (values[c_str[len - 1]] & 0x0f) != 0) || (tail == 3 && (values[c_str[len - 1]] & 0x03) != 0)) {
+        return 2;
+    }
+
+    uint64_t required = len / 4 * 3 + (tail == 0 ? 0 : tail - 1);
+    if (__SsoString_prepare_output(output_buffer, buffer_len, required) != 0) {
+        return 1;
+    }
+
+    uint8_t* out = *output_buffer;
+    uint64_t i = __SsoString_base64_decode_simd(c_str, len, out, url_safe);
+    uint64_t o = i / 4 * 3;
+    for (; i + 4 <= len; i += 4, o += 3) {
+        uint32_t group = ((uint32_t)values[c_str[i]] << 18) | ((uint32_t)values[c_str[i + 1]] << 12) |
+                         ((uint32_t)values[c_str[i + 2]] << 6) | (uint32_t)values[c_str[i + 3]];
+        out[o] = (uint8_t)(group >> 16);
+        out[o + 1] = (uint8_t)(group >> 8);
+        out[o + 2] = (uint8_t)group;
+    }
+    if (tail > 0) {
+        uint32_t group = ((uint32_t)values[c_str[i]] << 18) | ((uint32_t)values[c_str[i + 1]] << 12);
+        if (tail == 3) {
+            group |= (uint32_t)values[c_str[i + 2]] << 6;
+        }
+        out[o++] = (uint8_t)(group >> 16);
+        if (tail == 3) {
+            out[o++] = (uint8_t)(group >> 8);
+        }
+    }
+    return 0;
+}
+
+/// Match masks for Myers' bit-parallel edit distance. Bit i of block b for character c is set when
+/// pattern[b * 64 + i] == c. Patterns of up to 64 bytes use the inline table and never allocate.
+typedef struct __SsoMyersPattern {
+    uint64_t* peq;
+    uint64_t words;
+    uint64_t len;
+    uint64_t inline_peq[256];
+} __SsoMyersPattern;
+
+static void __SsoMyersPattern_init(__SsoMyersPattern* pattern, const uint8_t* chars, uint64_t len) {
+    pattern->len = len;
+    pattern->words = len == 0 ? 1 : (len + 63) / 64;
+    pattern->peq = pattern->inline_peq;
+    if (pattern->words > 1) {
+        pattern->peq = calloc(pattern->words * 256, sizeof(uint64_t));
+        if (!pattern->peq) {
+            perror("Failed to allocate memory in __SsoMyersPattern_init");
+            exit(1);
+        }
+    } else {
+        memset(pattern->inline_peq, 0, sizeof(pattern->inline_peq));
+    }
+
+    for (uint64_t i = 0; i < len; i++) {
+        pattern->peq[(uint64_t)chars[i] * pattern->words + i / 64] |= (uint64_t)1 << (i % 64);
+    }
+}
+
+static void __SsoMyersPattern_free(__SsoMyersPattern* pattern) {
+    if (pattern->peq != pattern->inline_peq) {
+        free(pattern->peq);
+    }
+}
+
+/// Runs Myers' algorithm (Hyyrö's multi word variant) of `pattern` over `text`, one column per text byte.
+/// In global mode this returns the edit distance of the two strings, giving up with -1 as soon as it can no
+/// longer be <= max_distance. In search mode the pattern may start anywhere in the text; this returns the
+/// smallest distance of any substring and stores the (exclusive) end of the first such substring in `end_index`.
+static int64_t __SsoString_myers(const __SsoMyersPattern* pattern, const uint8_t* text, uint64_t n,
+                                 bool search, uint64_t max_distance, uint64_t* end_index) {
+    uint64_t m = pattern->len;
+    if (m == 0) {
+        if (search) {
+            *end_index = 0;
+            return 0;
+        }
+        return n <= max_distance ? (int64_t)n : -1;
+    }
+    if (!search && (m > n ? m - n : n - m) > max_distance) {
+        return -1;
+    }
+
+    uint64_t words = pattern->words;
+    uint64_t inline_state[32];
+    uint64_t* pv = inline_state;
+    if (words > 16) {
+        pv = malloc(words * 2 * sizeof(uint64_t));
+        if (!pv) {
+            perror("Failed to allocate memory in __SsoString_myers");
+            exit(1);
+        }
+    }
+    uint64_t* mv = pv + words;
+    for (uint64_t b = 0; b < words; b++) {
+        pv[b] = UINT64_MAX;
+        mv[b] = 0;
+    }
+
+    uint64_t last_bit = (m - 1) % 64;
+    uint64_t score = m;
+    uint64_t best = m;
+    uint64_t best_end = 0;
+
+    for (uint64_t j = 0; j < n; j++) {
+        const uint64_t* eq_column = &pattern->peq[(uint64_t)text[j] * words];
+
+        // The top row is 0, 1, 2, ... in global mode and all zeros in search mode
+        int32_t hin = search ? 0 : 1;
+        for (uint64_t b = 0; b < words; b++) {
+            uint64_t hin_neg = hin < 0;
+            uint64_t hin_pos = hin > 0;
+
+            uint64_t eq = eq_column[b];
+            uint64_t xv = eq | mv[b];
+            eq |= hin_neg;
+            uint64_t xh = (((eq & pv[b]) + pv[b]) ^ pv[b]) | eq;
+            uint64_t ph = mv[b] | ~(xh | pv[b]);
+            uint64_t mh = pv[b] & xh;
+
+            // Rows below the end of the pattern never feed back upwards, so the
+            // score can be read straight from the pattern's last row
+            if (b == words - 1) {
+                score += (ph >> last_bit) & 1;
+                score -= (mh >> last_bit) & 1;
+            } else {
+                hin = (int32_t)(ph >> 63) - (int32_t)(mh >> 63);
+            }
+
+            ph = (ph << 1) | hin_pos;
+            mh = (mh << 1) | hin_neg;
+            pv[b] = mh | ~(xv | ph);
+            mv[b] = ph & xv;
+        }
+
+        if (search) {
+            if (score < best) {
+                best = score;
+                best_end = j + 1;
+            }
+        } else if (score > max_distance && score - max_distance > n - j - 1) {
+            // Each remaining column can lower the score by at most one
+            break;
+        }
+    }
+
+    if (pv != inline_state) {
+        free(pv);
+    }
+
+    if (!search) {
+        best = score;
+    }
+    if (best > max_distance) {
+        return -1;
+    }
+    if (end_index != NULL) {
+        *end_index = best_end;
+    }
+    return (int64_t)best;
+}
+
+/// @brief Computes the Levenshtein distance (byte wise) using Myers' bit-parallel algorithm.
+/// Runs in O(n * ceil(m / 64)) where m is the length of the shorter string.
+/// @param s1
+/// @param s2
+/// @return Returns the number of single byte insertions, deletions and substitutions that turn s1 into s2
+int64_t SsoString_edit_distance(const SsoString* s1, const SsoString* s2) {
+    return SsoString_edit_distance_bounded(s1, s2, UINT64_MAX);
+}
+
+/// @brief Same as `SsoString_edit_distance`, but stops as soon as the distance is known to exceed `max_distance`
+/// @param s1
+/// @param s2
+/// @param max_distance
+/// @return Returns the edit distance, or -1 if it is greater than `max_distance`
+int64_t SsoString_edit_distance_bounded(const SsoString* s1, const SsoString* s2, uint64_t max_distance) {
+    // Use the shorter string as the pattern so it needs as few words as possible
+    if (SsoString_len(s1) > SsoString_len(s2)) {
+        const SsoString* tmp = s1;
+        s1 = s2;
+        s2 = tmp;
+    }
+
+    __SsoMyersPattern pattern;
+    __SsoMyersPattern_init(&pattern, (const uint8_t*) SsoString_as_cstr(s1), SsoString_len(s1));
+    int64_t distance = __SsoString_myers(&pattern, (const uint8_t*) SsoString_as_cstr(s2),
+                                         SsoString_len(s2), false, max_distance, NULL);
+    __SsoMyersPattern_free(&pattern);
+    return distance;
+}
+
+/// @brief Finds the first substring of `str` that is within `max_distance` edits of `c_str` and has the lowest distance.
+/// @param str The string to search in
+/// @param c_str The string to search for
+/// @param max_distance
+/// @param match_len If not NULL, receives the length of the matched substring
+/// @param distance If not NULL, receives the edit distance of the match
+/// @return Returns the index of the first character of the match. Returns -1 if not found
+int64_t SsoString_fuzzy_find(const SsoString* str, const char* c_str, uint64_t max_distance, uint64_t* match_len, uint64_t* distance) {
+    const uint8_t* haystack = (const uint8_t*) SsoString_as_cstr(str);
+    uint64_t hay_len = SsoString_len(str);
+    uint64_t needle_len = strlen(c_str);
+
+    __SsoMyersPattern pattern;
+    __SsoMyersPattern_init(&pattern, (const uint8_t*) c_str, needle_len);
+
+    uint64_t end = 0;
+    int64_t best = __SsoString_myers(&pattern, haystack, hay_len, true, max_distance, &end);
+    if (best < 0) {
+        __SsoMyersPattern_free(&pattern);
+        return -1;
+    }
+
+    // The search pass only knows where the match ends. A match with distance k is between
+    // needle_len - k and needle_len + k long, so try each start in that window in order.
+    uint64_t k = (uint64_t)best;
+    uint64_t first = end > needle_len + k ? end - needle_len - k : 0;
+    uint64_t start = end;
+    for (uint64_t s = first; s <= end; s++) {
+        if (__SsoString_myers(&pattern, haystack + s, end - s, false, k, NULL) == best) {
+            start = s;
+            break;
+        }
+    }
+    __SsoMyersPattern_free(&pattern);
+
+    if (match_len != NULL) {
+        *match_len = end - start;
+    }
+    if (distance != NULL) {
+        *distance = k;
+    }
+    return (int64_t)start;
+}
+
+typedef struct __SsoEditDistanceJob {
+    const __SsoMyersPattern* pattern;
+    const SsoString* candidates;
+    int64_t* distances;
+    uint64_t begin;
+    uint64_t end;
+    uint64_t max_distance;
+} __SsoEditDistanceJob;
+
+static void* __SsoString_edit_distance_worker(void* arg) {
+    __SsoEditDistanceJob* job = (__SsoEditDistanceJob*) arg;
+    for (uint64_t i = job->begin; i < job->end; i++) {
+        const SsoString* candidate = &job->candidates[i];
+        job->distances[i] = __SsoString_myers(job->pattern, (const uint8_t*) SsoString_as_cstr(candidate),
+                                              SsoString_len(candidate), false, job->max_distance, NULL);
+    }
+    return NULL;
+}
+
+/// @brief Scores one query against an array of candidates. The query's match masks are built once and
+/// shared by every thread.
+/// @param query
+/// @param candidates
+/// @param n The number of strings in `candidates`
+/// @param max_distance Candidates further away than this get -1. Pass UINT64_MAX for exact distances
+/// @param distances Receives one result per candidate (same semantics as `SsoString_edit_distance_bounded`)
+/// @param num_threads The number of threads to use. 0 uses one per online CPU
+void SsoString_edit_distance_batch(const SsoString* query, const SsoString* candidates, uint64_t n, uint64_t max_distance, int64_t* distances, uint32_t num_threads) {
+    __SsoMyersPattern pattern;
+    __SsoMyersPattern_init(&pattern, (const uint8_t*) SsoString_as_cstr(query), SsoString_len(query));
+
+    if (num_threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = cpus > 0 ? (uint32_t) cpus : 1;
+    }
+    // Threads are not worth starting for a handful of candidates each
+    if (num_threads > n / 64) {
+        num_threads = (uint32_t)(n / 64);
+    }
+    if (num_threads <= 1) {
+        __SsoEditDistanceJob job = {&pattern, candidates, distances, 0, n, max_distance};
+        __SsoString_edit_distance_worker(&job);
+        __SsoMyersPattern_free(&pattern);
+        return;
+    }
+
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+    __SsoEditDistanceJob* jobs = malloc(num_threads * sizeof(__SsoEditDistanceJob));
+    if (!threads || !jobs) {
+        perror("Failed to allocate memory in SsoString_edit_distance_batch");
+        exit(1);
+    }
+
+    uint64_t chunk = (n + num_threads - 1) / num_threads;
+    uint32_t started = 0;
+    for (uint32_t t = 0; t < num_threads; t++) {
+        uint64_t begin = t * chunk;
+        uint64_t end = begin + chunk < n ? begin + chunk : n;
+        jobs[t] = (__SsoEditDistanceJob) {&pattern, candidates, distances, begin, end, max_distance};
+        if (pthread_create(&threads[t], NULL, __SsoString_edit_distance_worker, &jobs[t]) != 0) {
+            // Fall back to scoring this chunk on the calling thread
+            __SsoString_edit_distance_worker(&jobs[t]);
+            continue;
+        }
+        threads[started++] = threads[t];
+    }
+    for (uint32_t t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    free(threads);
+    free(jobs);
+    __SsoMyersPattern_free(&pattern);
+}
+
+/// Sets the length of a string whose characters have already been written
+static void __SsoString_set_len(SsoString* str, uint64_t len) {
+    if (SsoString_is_heap_allocated(str)) {
+        __HeapSsoStr* heap_str = (__HeapSsoStr*) str;
+        heap_str->ptr[len] = '\0';
+        heap_str->length = len | __SSO_STRING_64th_BIT_MAX;
+    } else {
+        __StackSsoStr* stack_str = (__StackSsoStr*) str;
+        stack_str->chars[len] = '\0';
+    }
+}
+
+#define __SSO_READ_BATCH_SIZE 64
+
+/// A file of a batch that has been opened and sized, waiting for its contents
+typedef struct __SsoPendingRead {
+    int fd;
+    uint64_t index;
+    uint64_t size;
+    char* chars;
+} __SsoPendingRead;
+
+/// Opens a file and sizes `out` from its metadata. Returns false if the file cannot be opened or is not a regular file.
+static bool __SsoString_open_for_read(const char* path, SsoString* out, __SsoPendingRead* pending) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    bool sized = false;
+    bool regular = false;
+    uint64_t size = 0;
+#ifdef STATX_SIZE
+    struct statx stx;
+    if (statx(fd, "", AT_EMPTY_PATH, STATX_TYPE | STATX_SIZE, &stx) == 0) {
+        sized = true;
+        regular = S_ISREG(stx.stx_mode);
+        size = stx.stx_size;
+    } else if (errno != ENOSYS && errno != EPERM) {
+        close(fd);
+        return false;
+    }
+#endif
+    // Older kernels and some seccomp sandboxes reject statx at run time
+    if (!sized) {
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            sized = true;
+            regular = S_ISREG(st.st_mode);
+            size = (uint64_t) st.st_size;
+        }
+    }
+    if (!sized || !regular) {
+        close(fd);
+        return false;
+    }
+
+    pending->fd = fd;
+    pending->size = size;
+    pending->chars = __SsoString_init_with_len(out, size);
+    return true;
+}
+
+/// Reads `pending->size - done` more bytes with plain syscalls and closes the file. Handles short
+/// reads and files that shrank since they were sized. Returns false on a read error.
+static bool __SsoString_finish_read(__SsoPendingRead* pending, SsoString* out, uint64_t done) {
+    // Pseudo files (procfs, sysfs) report a size of 0, so they are read until EOF instead, straight into a
+    // buffer that doubles whenever it fills up. Their contents may hold null bytes (/proc/self/cmdline,
+    // /proc/self/environ), so everything is appended by byte count.
+    if (pending->size == 0) {
+        uint64_t capacity = 4096;
+        uint64_t len = 0;
+        uint8_t* chars = malloc(capacity);
+        if (!chars) {
+            perror("Failed to allocate memory in __SsoString_finish_read");
+            exit(1);
+        }
+        while (true) {
+            if (len + 1 == capacity) {
+                capacity *= 2;
+                uint8_t* new_chars = realloc(chars, capacity);
+                if (!new_chars) {
+                    perror("Failed to reallocate memory in __SsoString_finish_read");
+                    exit(1);
+                }
+                chars = new_chars;
+            }
+            ssize_t got = read(pending->fd, chars + len, capacity - len - 1);
+            if (got < 0 && errno == EINTR) {
+                continue;
+            } else if (got < 0) {
+                free(chars);
+                close(pending->fd);
+                return false;
+            } else if (got == 0) {
+                break;
+            }
+            len += (uint64_t) got;
+        }
+        close(pending->fd);
+
+        if (len <= 22 && !memchr(chars, '\0', len)) {
+            memcpy(__SsoString_init_with_len(out, len), chars, len);
+            free(chars);
+        } else {
+            __HeapSsoStr* heap_str = (__HeapSsoStr*) out;
+            chars[len] = '\0';
+            heap_str->ptr = chars;
+            heap_str->capacity = capacity;
+            heap_str->length = len | __SSO_STRING_64th_BIT_MAX;
+        }
+        return true;
+    }
+
+    while (done < pending->size) {
+        ssize_t got = pread(pending->fd, pending->chars + done, pending->size - done, (off_t) done);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        } else if (got < 0) {
+            close(pending->fd);
+            return false;
+        } else if (got == 0) {
+            break;
+        }
+        done += (uint64_t) got;
+    }
+    close(pending->fd);
+    __SsoString_set_len(out, done);
+
+    // The length of an inline string comes from strlen, so short contents with a null byte move to the heap
+    if (!SsoString_is_heap_allocated(out) && memchr(pending->chars, '\0', done)) {
+        char inline_chars[23];
+        memcpy(inline_chars, pending->chars, done);
+        __HeapSsoStr* heap_str = (__HeapSsoStr*) out;
+        heap_str->capacity = done + 1;
+        heap_str->length = done | __SSO_STRING_64th_BIT_MAX;
+        heap_str->ptr = malloc(heap_str->capacity);
+        if (!heap_str->ptr) {
+            perror("Failed to allocate memory in __SsoString_finish_read");
+            exit(1);
+        }
+        memcpy(heap_str->ptr, inline_chars, done);
+        heap_str->ptr[done] = '\0';
+    }
+    return true;
+}
+
+#ifdef __SSO_STRING_IO_URING
+/// A minimal io_uring set up through the raw syscalls, so there is no dependency on liburing
+typedef struct __SsoUring {
+    int fd;
+    void* sq_ring;
+    void* cq_ring;
+    size_t sq_ring_size;
+    size_t cq_ring_size;
+    struct io_uring_sqe* sqes;
+    size_t sqes_size;
+    uint32_t* sq_tail;
+    uint32_t* sq_mask;
+    uint32_t* sq_array;
+    uint32_t* cq_head;
+    uint32_t* cq_tail;
+    uint32_t* cq_mask;
+    struct io_uring_cqe* cqes;
+} __SsoUring;
+
+static bool __SsoUring_init(__SsoUring* ring, uint32_t entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring->fd = (int) syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0) {
+        return false;
+    }
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap && ring->cq_ring_size > ring->sq_ring_size) {
+        ring->sq_ring_size = ring->cq_ring_size;
+    }
+
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring->fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ring == MAP_FAILED) {
+        close(ring->fd);
+        return false;
+    }
+    ring->cq_ring = ring->sq_ring;
+    if (!single_mmap) {
+        ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             ring->fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ring == MAP_FAILED) {
+            munmap(ring->sq_ring, ring->sq_ring_size);
+            close(ring->fd);
+            return false;
+        }
+    }
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring->fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        if (ring->cq_ring != ring->sq_ring) {
+            munmap(ring->cq_ring, ring->cq_ring_size);
+        }
+        munmap(ring->sq_ring, ring->sq_ring_size);
+        close(ring->fd);
+        return false;
+    }
+
+    uint8_t* sq = (uint8_t*) ring->sq_ring;
+    uint8_t* cq = (uint8_t*) ring->cq_ring;
+    ring->sq_tail = (uint32_t*) (sq + params.sq_off.tail);
+    ring->sq_mask = (uint32_t*) (sq + params.sq_off.ring_mask);
+    ring->sq_array = (uint32_t*) (sq + params.sq_off.array);
+    ring->cq_head = (uint32_t*) (cq + params.cq_off.head);
+    ring->cq_tail = (uint32_t*) (cq + params.cq_off.tail);
+    ring->cq_mask = (uint32_t*) (cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*) (cq + params.cq_off.cqes);
+    return true;
+}
+
+static void __SsoUring_free(__SsoUring* ring) {
+    munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+}
+
+/// Reads every pending file through the ring. Reads the ring rejects or leaves short are finished with
+/// plain syscalls. Returns false if the ring itself stopped working before anything was submitted.
+static bool __SsoUring_read_all(__SsoUring* ring, __SsoPendingRead* pending, uint64_t count, SsoString* out, uint64_t* failed) {
+    uint32_t tail = *ring->sq_tail;
+    uint32_t mask = *ring->sq_mask;
+    for (uint64_t i = 0; i < count; i++) {
+        uint32_t slot = tail & mask;
+        struct io_uring_sqe* sqe = &ring->sqes[slot];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = pending[i].fd;
+        sqe->addr = (uint64_t) (uintptr_t) pending[i].chars;
+        sqe->len = pending[i].size > UINT32_MAX ? UINT32_MAX : (uint32_t) pending[i].size;
+        sqe->off = 0;
+        sqe->user_data = i;
+        ring->sq_array[slot] = slot;
+        tail++;
+    }
+    __atomic_store_n(ring->sq_tail, tail, __ATOMIC_RELEASE);
+
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    while (completed < count) {
+        uint32_t to_submit = (uint32_t) (count - submitted);
+        long entered = syscall(__NR_io_uring_enter, ring->fd, to_submit, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        if (entered < 0 && errno != EINTR && submitted == 0) {
+            // Nothing is in flight, so the caller can safely take over with plain syscalls
+            return false;
+        }
+        if (entered > 0) {
+            submitted += (uint64_t) entered;
+        }
+
+        uint32_t head = *ring->cq_head;
+        while (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+            struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+            __SsoPendingRead* read = &pending[cqe->user_data];
+            // A rejected read (for example an old kernel without IORING_OP_READ) is retried from the start
+            uint64_t done = cqe->res > 0 ? (uint64_t) cqe->res : 0;
+            if (!__SsoString_finish_read(read, &out[read->index], done)) {
+                SsoString_free(&out[read->index]);
+                __SsoString_init_with_len(&out[read->index], 0);
+                (*failed)++;
+            }
+            read->fd = -1;
+            completed++;
+            head++;
+        }
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    }
+    return true;
+}
+#endif
+
+/// @brief Reads whole files into strings. Each string is sized from the file's metadata and the file is read
+/// straight into its final inline or heap buffer. On Linux the reads are submitted in batches through io_uring,
+/// elsewhere (or if io_uring is unavailable) plain syscalls are used.
+/// @param paths
+/// @param n The number of paths
+/// @param out Receives one string per path. Files that cannot be read are set to an empty string
+/// @return Returns the number of files that could not be read
+uint64_t SsoString_read_files_batch(const char** paths, uint64_t n, SsoString* out) {
+    __SsoPendingRead pending[__SSO_READ_BATCH_SIZE];
+    uint64_t failed = 0;
+
+#ifdef __SSO_STRING_IO_URING
+    __SsoUring ring;
+    memset(&ring, 0, sizeof(ring));
+    bool use_ring = n > 1 && __SsoUring_init(&ring, __SSO_READ_BATCH_SIZE);
+#endif
+
+    // Work in batches so at most __SSO_READ_BATCH_SIZE files are open at once
+    for (uint64_t batch_start = 0; batch_start < n; batch_start += __SSO_READ_BATCH_SIZE) {
+        uint64_t batch_end = batch_start + __SSO_READ_BATCH_SIZE < n ? batch_start + __SSO_READ_BATCH_SIZE : n;
+        uint64_t count = 0;
+        for (uint64_t i = batch_start; i < batch_end; i++) {
+            if (__SsoString_open_for_read(paths[i], &out[i], &pending[count])) {
+                pending[count].index = i;
+                count++;
+            } else {
+                __SsoString_init_with_len(&out[i], 0);
+                failed++;
+            }
+        }
+
+#ifdef __SSO_STRING_IO_URING
+        if (use_ring) {
+            if (__SsoUring_read_all(&ring, pending, count, out, &failed)) {
+                continue;
+            }
+            // Stop using the ring and let the loop below finish the files it did not complete
+            __SsoUring_free(&ring);
+            use_ring = false;
+        }
+#endif
+
+        for (uint64_t i = 0; i < count; i++) {
+            if (pending[i].fd < 0) {
+                continue;
+            }
+            if (!__SsoString_finish_read(&pending[i], &out[pending[i].index], 0)) {
+                SsoString_free(&out[pending[i].index]);
+                __SsoString_init_with_len(&out[pending[i].index], 0);
+                failed++;
+            }
+        }
+    }
+
+#ifdef __SSO_STRING_IO_URING
+    if (use_ring) {
+        __SsoUring_free(&ring);
+    }
+#endif
+    return failed;
+}
+
+/// @brief Compiles a glob pattern. Supports `*`, `?`, `[...]` (with ranges and `!`/`^` negation) and `\` escapes.
+/// @param glob The compiled pattern is written here
+/// @param pattern
+/// @return 0 on success, 1 if the pattern is malformed, 2 if it has more than 63 non-`*` tokens
+int32_t SsoGlob_compile(SsoGlob* glob, const char* pattern) {
+    memset(glob, 0, sizeof(SsoGlob));
+
+    uint64_t state = 0;
+    const char* p = pattern;
+
+    while (*p != '\0') {
+        // Consecutive stars collapse into a single self loop on the current state
+        if (*p == '*') {
+            glob->star_mask |= (uint64_t)1 << state;
+            p++;
+            continue;
+        }
+
+        if (state >= __SSO_GLOB_MAX_TOKENS) {
+            return 2;
+        }
+        uint64_t bit = (uint64_t)1 << (state + 1);
+
+        if (*p == '?') {
+            for (int32_t c = 0; c < 256; c++) {
+                glob->char_masks[c] |= bit;
+            }
+            p++;
+        } else if (*p == '[') {
+            p++;
+            bool negate = false;
+            if (*p == '!' || *p == '^') {
+                negate = true;
+                p++;
+            }
+
+            bool members[256] = {0};
+            bool first = true;
+            while (*p != '\0' && (*p != ']' || first)) {
+                first = false;
+                if (*p == '\\') {
+                    p++;
+                    if (*p == '\0') {
+                        return 1;
+                    }
+                }
+                uint8_t lo = (uint8_t)*p++;
+                uint8_t hi = lo;
+                if (*p == '-' && p[1] != ']' && p[1] != '\0') {
+                    p++;
+                    if (*p == '\\') {
+                        p++;
+                        if (*p == '\0') {
+                            return 1;
+                        }
+                    }
+                    hi = (uint8_t)*p++;
+                }
+                for (int32_t c = lo; c <= hi; c++) {
+                    members[c] = true;
+                }
+            }
+
+            // Unterminated class
+            if (*p != ']') {
+                return 1;
+            }
+            p++;
+
+            for (int32_t c = 0; c < 256; c++) {
+                if (members[c] != negate) {
+                    glob->char_masks[c] |= bit;
+                }
+            }
+        } else {
+            if (*p == '\\') {
+                p++;
+                if (*p == '\0') {
+                    return 1;
+                }
+            }
+            glob->char_masks[(uint8_t)*p] |= bit;
+            p++;
+        }
+
+        state++;
+    }
+
+    glob->accept_mask = (uint64_t)1 << state;
+    return 0;
+}
+
+/// @brief Matches `len` bytes starting at `c_str` against a compiled glob. Runs in O(len) and does not allocate.
+/// @param glob
+/// @param c_str
+/// @param len
+/// @return Returns true if the whole input matches the pattern
+bool SsoGlob_match_cstr(const SsoGlob* glob, const char* c_str, uint64_t len) {
+    uint64_t states = 1;
+
+    for (uint64_t i = 0; i < len; i++) {
+        uint64_t mask = glob->char_masks[(uint8_t)c_str[i]];
+        states = ((states << 1) & mask) | (states & glob->star_mask);
+        if (states == 0) {
+            return false;
+        }
+    }
+
+    return (states & glob->accept_mask) != 0;
+}
+
+/// @brief
+/// @param glob
+/// @param str
+/// @return Returns true if the whole string matches the pattern
+bool SsoGlob_match(const SsoGlob* glob, const SsoString* str) {
+    return SsoGlob_match_cstr(glob, SsoString_as_cstr(str), SsoString_len(str));
+}
+
+/// @brief Matches one compiled pattern against an array of strings
+/// @param glob
+/// @param strs
+/// @param n The number of strings in `strs`
+/// @param results If not NULL, results[i] is set to whether strs[i] matched
+/// @return Returns the number of strings that matched
+uint64_t SsoGlob_match_batch(const SsoGlob* glob, const SsoString* strs, uint64_t n, bool* results) {
+    uint64_t count = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        bool matched = SsoGlob_match(glob, &strs[i]);
+        if (results != NULL) {
+            results[i] = matched;
+        }
+        count += matched;
+    }
+    return count;
+}
@@ -1,4 +1,6 @@
 #include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
 #include "../include/sso_string.h"
 
 
@@ -229,6 +231,251 @@ void test_SsoString_split() {
        SsoString_free(&s_split7);
 }
 
+void test_SsoGlob() {
+       printf("\nTest 11 (SsoGlob):\n");
+
+       SsoGlob glob;
+       int32_t result = SsoGlob_compile(&glob, "svc-*.prod.?z");
+       printf("Compile \"svc-*.prod.?z\" result: %d (expected 0)\n", result);
+
+       SsoString keys[4] = {
+              SsoString_from_cstr("svc-auth.prod.az"),
+              SsoString_from_cstr("svc-a-much-longer-service-name.prod.bz"),
+              SsoString_from_cstr("svc-auth.staging.az"),
+              SsoString_from_cstr("svc-.prod.zz"),
+       };
+       bool matches[4];
+       uint64_t count = SsoGlob_match_batch(&glob, keys, 4, matches);
+       for (uint64_t i = 0; i < 4; i++) {
+              printf("  \"%s\" matched: %d\n", SsoString_as_cstr(&keys[i]), matches[i]);
+       }
+       printf("Batch matched %lu strings (expected 3)\n", count);
+
+       // Character classes, negation and escapes
+       SsoGlob_compile(&glob, "[a-c][!0-9]\\*");
+       SsoString s_glob1 = SsoString_from_cstr("bx*");
+       SsoString s_glob2 = SsoString_from_cstr("b5*");
+       printf("\n\"[a-c][!0-9]\\*\" vs \"bx*\": %d (expected 1)\n", SsoGlob_match(&glob, &s_glob1));
+       printf("\"[a-c][!0-9]\\*\" vs \"b5*\": %d (expected 0)\n", SsoGlob_match(&glob, &s_glob2));
+
+       result = SsoGlob_compile(&glob, "[abc");
+       printf("Compile unterminated class result: %d (expected 1)\n", result);
+
+       for (uint64_t i = 0; i < 4; i++) {
+              SsoString_free(&keys[i]);
+       }
+       SsoString_free(&s_glob1);
+       SsoString_free(&s_glob2);
+}
+
+void test_SsoString_numbers() {
+       printf("\nTest 12 (number formatting and parsing):\n");
+
+       SsoString s_i64 = SsoString_from_i64(INT64_MIN);
+       printf("from_i64(INT64_MIN): `%s`, Heap allocated: %d (expected -9223372036854775808, 0)\n",
+              SsoString_as_cstr(&s_i64), SsoString_is_heap_allocated(&s_i64));
+
+       SsoString s_u64 = SsoString_from_u64(UINT64_MAX);
+       printf("from_u64(UINT64_MAX): `%s` (expected 18446744073709551615)\n", SsoString_as_cstr(&s_u64));
+
+       double f64_values[4] = {0.1, -2.5, 1e300, 0.1 + 0.2};
+       for (uint64_t i = 0; i < 4; i++) {
+              SsoString s_f64 = SsoString_from_f64(f64_values[i]);
+              double parsed = 0;
+              int32_t result = SsoString_parse_f64(&s_f64, &parsed);
+              printf("from_f64: `%s`, parse result: %d, round trips: %d (expected 0, 1)\n",
+                     SsoString_as_cstr(&s_f64), result, parsed == f64_values[i]);
+              SsoString_free(&s_f64);
+       }
+
+       int64_t parsed_i64 = 0;
+       int32_t result = SsoString_parse_i64(&s_i64, &parsed_i64);
+       printf("\nparse_i64(`%s`): %d, value: %ld (expected 0, -9223372036854775808)\n",
+              SsoString_as_cstr(&s_i64), result, parsed_i64);
+
+       result = SsoString_parse_i64(&s_u64, &parsed_i64);
+       printf("parse_i64(`%s`): %d (expected 2)\n", SsoString_as_cstr(&s_u64), result);
+
+       SsoString s_invalid = SsoString_from_cstr("12.5e");
+       double parsed_f64 = 0;
+       result = SsoString_parse_f64(&s_invalid, &parsed_f64);
+       printf("parse_f64(`%s`): %d (expected 1)\n", SsoString_as_cstr(&s_invalid), result);
+
+       SsoString_free(&s_i64);
+       SsoString_free(&s_u64);
+       SsoString_free(&s_invalid);
+}
+
+void test_SsoString_encoding() {
+       printf("\nTest 13 (hex and base64):\n");
+
+       const uint8_t hash[20] = {
+              0xda, 0x39, 0xa3, 0xee, 0x5e, 0x6b, 0x4b, 0x0d, 0x32, 0x55,
+              0xbf, 0xef, 0x95, 0x60, 0x18, 0x90, 0xaf, 0xd8, 0x07, 0x09,
+       };
+       SsoString s_hex = SsoString_hex_encode(hash, 20);
+       printf("hex_encode: `%s`, Heap allocated: %d\n(expected da39a3ee5e6b4b0d3255bfef95601890afd80709, 1)\n",
+              SsoString_as_cstr(&s_hex), SsoString_is_heap_allocated(&s_hex));
+
+       uint8_t* decoded = NULL;
+       uint64_t decoded_len = 0;
+       int32_t result = SsoString_hex_decode(&s_hex, &decoded, &decoded_len);
+       printf("hex_decode result: %d, Length: %lu, equals input: %d (expected 0, 20, 1)\n",
+              result, decoded_len, memcmp(decoded, hash, 20) == 0);
+       free(decoded);
+
+       SsoString s_bad_hex = SsoString_from_cstr("abz0");
+       decoded_len = 0;
+       result = SsoString_hex_decode(&s_bad_hex, &decoded, &decoded_len);
+       printf("hex_decode(`abz0`) result: %d (expected 2)\n", result);
+
+       SsoString s_b64 = SsoString_base64_encode((const uint8_t*) "any carnal pleas", 16, false);
+       SsoString s_b64_url = SsoString_base64_encode((const uint8_t*) "\xfb\xff", 2, true);
+       printf("\nbase64_encode: `%s`, Heap allocated: %d (expected YW55IGNhcm5hbCBwbGVhcw==, 1)\n",
+              SsoString_as_cstr(&s_b64), SsoString_is_heap_allocated(&s_b64));
+       printf("base64_encode (url safe): `%s`, Heap allocated: %d (expected -_8, 0)\n",
+              SsoString_as_cstr(&s_b64_url), SsoString_is_heap_allocated(&s_b64_url));
+
+       uint8_t small_buffer[4];
+       uint8_t* small_buffer_ptr = small_buffer;
+       decoded_len = sizeof(small_buffer);
+       result = SsoString_base64_decode(&s_b64, false, &small_buffer_ptr, &decoded_len);
+       printf("base64_decode into a 4 byte buffer result: %d, Required: %lu (expected 1, 16)\n", result, decoded_len);
+
+       decoded_len = 0;
+       result = SsoString_base64_decode(&s_b64, false, &decoded, &decoded_len);
+       printf("base64_decode result: %d, Output: `%.*s` (expected 0, any carnal pleas)\n",
+              result, (int) decoded_len, decoded);
+       free(decoded);
+
+       decoded_len = 0;
+       result = SsoString_base64_decode(&s_b64_url, false, &decoded, &decoded_len);
+       printf("base64_decode of url safe input with the standard alphabet result: %d (expected 2)\n", result);
+
+       SsoString_free(&s_hex);
+       SsoString_free(&s_bad_hex);
+       SsoString_free(&s_b64);
+       SsoString_free(&s_b64_url);
+}
+
+void test_SsoString_edit_distance() {
+       printf("\nTest 14 (edit distance and fuzzy find):\n");
+
+       SsoString s_kitten = SsoString_from_cstr("kitten");
+       SsoString s_sitting = SsoString_from_cstr("sitting");
+       printf("edit_distance(`kitten`, `sitting`): %ld (expected 3)\n",
+              SsoString_edit_distance(&s_kitten, &s_sitting));
+       printf("edit_distance_bounded(`kitten`, `sitting`, 2): %ld (expected -1)\n",
+              SsoString_edit_distance_bounded(&s_kitten, &s_sitting, 2));
+
+       SsoString s_haystack = SsoString_from_cstr("configuration.templates.servce-auth.yaml");
+       uint64_t match_len = 0;
+       uint64_t distance = 0;
+       int64_t index = SsoString_fuzzy_find(&s_haystack, "service", 1, &match_len, &distance);
+       printf("fuzzy_find(`service`, 1): Index = %ld, Length: %lu, Distance: %lu (expected 24, 6, 1)\n",
+              index, match_len, distance);
+       index = SsoString_fuzzy_find(&s_haystack, "database", 2, NULL, NULL);
+       printf("fuzzy_find(`database`, 2): Index = %ld (expected -1)\n", index);
+
+       SsoString candidates[3] = {
+              SsoString_from_cstr("sitting"),
+              SsoString_from_cstr("kitchen"),
+              SsoString_from_cstr("a completely unrelated candidate string"),
+       };
+       int64_t distances[3];
+       SsoString_edit_distance_batch(&s_kitten, candidates, 3, 5, distances, 0);
+       printf("edit_distance_batch(`kitten`, max 5): %ld %ld %ld (expected 3 2 -1)\n",
+              distances[0], distances[1], distances[2]);
+
+       SsoString_free(&s_kitten);
+       SsoString_free(&s_sitting);
+       SsoString_free(&s_haystack);
+       for (uint64_t i = 0; i < 3; i++) {
+              SsoString_free(&candidates[i]);
+       }
+}
+
+void test_SsoString_read_files_batch() {
+       printf("\nTest 15 (SsoString_read_files_batch):\n");
+
+       char short_path[] = "/tmp/sso_string_test_XXXXXX";
+       char long_path[] = "/tmp/sso_string_test_XXXXXX";
+       int short_fd = mkstemp(short_path);
+       int long_fd = mkstemp(long_path);
+       const char* long_contents = "a file that is long enough to need a heap allocation\n";
+       if (write(short_fd, "key = value\n", 12) != 12 ||
+           write(long_fd, long_contents, strlen(long_contents)) != (ssize_t) strlen(long_contents)) {
+              printf("Failed to write the test files\n");
+       }
+       close(short_fd);
+       close(long_fd);
+
+       const char* paths[3] = {short_path, long_path, "/this/file/does/not/exist"};
+       SsoString contents[3];
+       uint64_t failed = SsoString_read_files_batch(paths, 3, contents);
+       printf("Failed reads: %lu (expected 1)\n", failed);
+       for (uint64_t i = 0; i < 3; i++) {
+              printf("  File %lu: Length: %lu, Heap allocated: %d\n",
+                     i, SsoString_len(&contents[i]), SsoString_is_heap_allocated(&contents[i]));
+       }
+       printf("(expected lengths 12, %lu, 0 and heap allocated 0, 1, 0)\n", strlen(long_contents));
+
+       // Pseudo files report a size of 0 and may contain null bytes (the arguments here are separated by them)
+       char cmdline[4096];
+       int cmdline_fd = open("/proc/self/cmdline", O_RDONLY);
+       ssize_t cmdline_len = cmdline_fd < 0 ? -1 : read(cmdline_fd, cmdline, sizeof(cmdline));
+       if (cmdline_fd >= 0) {
+              close(cmdline_fd);
+       }
+       const char* proc_paths[1] = {"/proc/self/cmdline"};
+       SsoString proc_contents[1];
+       SsoString_read_files_batch(proc_paths, 1, proc_contents);
+       printf("/proc/self/cmdline: Length: %lu, Matches read(): %d (expected %ld, 1)\n",
+              SsoString_len(&proc_contents[0]),
+              (int64_t) SsoString_len(&proc_contents[0]) == cmdline_len &&
+                     memcmp(SsoString_as_cstr(&proc_contents[0]), cmdline, (size_t) cmdline_len) == 0,
+              (long) cmdline_len);
+       SsoString_free(&proc_contents[0]);
+
+       for (uint64_t i = 0; i < 3; i++) {
+              SsoString_free(&contents[i]);
+       }
+       unlink(short_path);
+       unlink(long_path);
+}
+
+void test_SsoString_shrink() {
+       printf("\nTest 16 (shrink_to_fit, auto demotion and memory usage):\n");
+
+       SsoString s_shrink1 = SsoString_from_cstr("0123456789 0123456789 0123456789");
+       SsoString_push_cstr(&s_shrink1, " some extra text to grow the capacity");
+       printf("Before shrink: Length: %lu, Memory usage: %lu\n",
+              SsoString_len(&s_shrink1), SsoString_memory_usage(&s_shrink1));
+       SsoString_shrink_to_fit(&s_shrink1);
+       printf("After shrink:  Length: %lu, Memory usage: %lu (expected 69, 94)\n",
+              SsoString_len(&s_shrink1), SsoString_memory_usage(&s_shrink1));
+
+       SsoString s_shrink2 = SsoString_from_cstr("          short after trimming          ");
+       SsoString_trim(&s_shrink2);
+       printf("\nTrimmed without auto demotion: `%s`, Heap allocated: %d (expected 1)\n",
+              SsoString_as_cstr(&s_shrink2), SsoString_is_heap_allocated(&s_shrink2));
+       SsoString_shrink_to_fit(&s_shrink2);
+       printf("After shrink: `%s`, Heap allocated: %d, Memory usage: %lu (expected 0, 24)\n",
+              SsoString_as_cstr(&s_shrink2), SsoString_is_heap_allocated(&s_shrink2),
+              SsoString_memory_usage(&s_shrink2));
+
+       SsoString_set_auto_demote(true);
+       SsoString s_shrink3 = SsoString_from_cstr("          short after trimming          ");
+       SsoString_trim(&s_shrink3);
+       printf("Trimmed with auto demotion: `%s`, Heap allocated: %d (expected 0)\n",
+              SsoString_as_cstr(&s_shrink3), SsoString_is_heap_allocated(&s_shrink3));
+       SsoString_set_auto_demote(false);
+
+       SsoString_free(&s_shrink1);
+       SsoString_free(&s_shrink2);
+       SsoString_free(&s_shrink3);
+}
+
 int main() {
     // Test 1: Create a short (stack-allocated) string
     SsoString s1 = SsoString_from_cstr("Hello");
@@ -338,6 +585,12 @@ int main() {
 
     test_SsoString_trim();
     test_SsoString_split();
+    test_SsoGlob();
+    test_SsoString_numbers();
+    test_SsoString_encoding();
+    test_SsoString_edit_distance();
+    test_SsoString_read_files_batch();
+    test_SsoString_shrink();
 
     return 0;
 }